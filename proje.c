@@ -1,3 +1,4 @@
+#define _GNU_SOURCE             // sched_setaffinity, pthread_setaffinity_np, sched_getcpu için
 #include <stdio.h>
 #include <stdlib.h>
 #include <unistd.h>
@@ -5,6 +6,11 @@
 #include <semaphore.h>
 #include <sys/wait.h>
 #include <string.h>
+#include <sched.h>
+#include <getopt.h>
+#include <time.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
 
 // Sabit değerler
 #define KAT_SAYISI 10           // Toplam kat sayısı (40x2)
@@ -34,8 +40,34 @@ typedef struct {
     int global_daire_id;        // Genel daire ID'si
     int pipe_talep_fd;          // Malzeme talep pipe'ı (yazma)
     int pipe_cevap_fd;          // Malzeme cevap pipe'ı (okuma)
+    int cekirdek;               // Thread'in sabitleneceği çekirdek (-1: katın kümesini miras alır)
 } DaireInfo;
 
+// Kat process'lerinin çekirdeklere yerleşim biçimi
+typedef enum {
+    KAT_SERBEST = 0,            // Zamanlayıcıya bırakılır (sabitleme yok)
+    KAT_YAY,                    // Her kat sıradaki çekirdek grubuna yayılır
+    KAT_TOPLA                   // Tüm katlar aynı çekirdek grubunda toplanır
+} KatYerlesimi;
+
+// Komut satırından gelen yerleşim ayarları
+typedef struct {
+    int depo_cekirdek;          // Deponun sabitleneceği çekirdek (-1: serbest)
+    KatYerlesimi kat_yerlesim;  // Kat process'lerinin yerleşimi
+    int grup_boyutu;            // Bir çekirdek grubundaki çekirdek sayısı
+    int daire_sabitle;          // 1: her daire thread'i katın kümesinde ayrı bir çekirdeğe sabitlenir
+} YerlesimAyari;
+
+// Process'ler arası paylaşılan ölçüm sayaçları (mmap ile paylaşılır)
+typedef struct {
+    long daire_goc_sayisi;      // Daire thread'lerinin çekirdek göçü sayısı (se.nr_migrations)
+    long depo_goc_sayisi;       // Depo process'inin çekirdek göçü sayısı (se.nr_migrations)
+    int goc_olculemedi;         // 1: /proc/.../sched okunamadı, göç sayıları eksik
+    long talep_sayisi;          // Depoya yapılan talep sayısı
+    long toplam_gecikme_ns;     // Talep-cevap gidiş dönüş sürelerinin toplamı
+    long max_gecikme_ns;        // En uzun talep-cevap süresi
+} YerlesimIstatistik;
+
 // Process içinde kullanılan mutexler (her process kendi mutex'ini kullanır)
 pthread_mutex_t vinc_mutex;         // Vinç kullanımı için mutex
 pthread_mutex_t asansor_mutex;      // Asansör kullanımı için mutex
@@ -55,6 +87,19 @@ sem_t yangin_alarm_sem;         // Yangın alarmı teknisyeni sınırlaması (3
 int toplam_malzeme = 10;       // 80 daire x 2 birim = 80 birim (normal miktar)
 int malzeme_tukendi = 0;       // Malzeme tükenme durumu flag'i (0: devam, 1: tükendi)
 
+// Yerleşim ayarları ve ölçümler
+YerlesimAyari yerlesim = { -1, KAT_SERBEST, DAIRE_SAYISI, 0 };
+int kat_cekirdekleri[CPU_SETSIZE];     // Katlara ayrılan çekirdekler (depo çekirdeği hariç)
+int kat_cekirdek_sayisi = 0;
+int cekirdek_paketi[CPU_SETSIZE];      // Her çekirdeğin soketi (physical_package_id)
+int cekirdek_kimligi[CPU_SETSIZE];     // Her çekirdeğin fiziksel çekirdek numarası (core_id)
+int depo_paketi = 0;                   // Deponun (veya ilk kat çekirdeğinin) soketi
+int grup_ilk[CPU_SETSIZE + 1];         // Her grubun kat_cekirdekleri içindeki ilk indeksi
+int grup_sayisi = 0;
+int yay_sirasi[CPU_SETSIZE];           // Yayma yerleşiminde grupların kullanım sırası
+int soket_sayisi = 0;
+YerlesimIstatistik* istatistik = NULL; // fork() öncesi paylaşımlı bellekte oluşturulur
+
 // Fonksiyon prototipleri (implicit declaration hatalarını önlemek için)
 void guvenli_yazdir(const char* mesaj);
 int malzeme_islem(int miktar, int daire_id, int kat_no, int islem_turu, int pipe_talep_fd, int pipe_cevap_fd);
@@ -66,6 +111,16 @@ void kat_insa_et(int kat_no, int pipe_talep_fd, int pipe_cevap_fd);
 void process_senkronizasyon_baslat(void);
 void process_senkronizasyon_temizle(void);
 void malzeme_sunucu_calistir(int pipe_talep_fd, int pipe_cevap_fd);
+void yerlesim_ayarlarini_oku(int argc, char* argv[]);
+int topoloji_oku(int cekirdek, const char* alan);
+int cekirdek_karsilastir(const void* a, const void* b);
+int depo_kardesi_mi(int cekirdek);
+void kat_cekirdeklerini_hazirla(void);
+int cekirdek_grubu_sec(int kat_no);
+void cekirdek_grubu_kumesi(int grup, cpu_set_t* kume);
+int daire_cekirdegi_sec(int ilk, int son, int sira);
+long goc_sayisi_oku(void);
+void goc_sayisi_kaydet(long baslangic, long* sayac);
 
 /**
  * Güvenli konsol çıktısı için fonksiyon
@@ -86,6 +141,8 @@ int malzeme_islem(int miktar, int daire_id, int kat_no, int islem_turu, int pipe
     char buffer[MAX_BUFFER];
     MalzemeTalebi talep;
     MalzemeCevabi cevap;
+    struct timespec baslangic, bitis;
+    long gecikme_ns, eski_max;
     
     // Pipe erişimini senkronize et (birden fazla thread aynı pipe'ı kullanacak)
     pthread_mutex_lock(&pipe_mutex);
@@ -96,11 +153,24 @@ int malzeme_islem(int miktar, int daire_id, int kat_no, int islem_turu, int pipe
     talep.kat_no = kat_no;
     talep.islem_turu = islem_turu;
     
-    // Parent process'e talep gönder
+    // Parent process'e talep gönder (depo gecikmesi mutex alındıktan sonra ölçülür)
+    clock_gettime(CLOCK_MONOTONIC, &baslangic);
     write(pipe_talep_fd, &talep, sizeof(MalzemeTalebi));
     
     // Parent'tan cevap bekle
     read(pipe_cevap_fd, &cevap, sizeof(MalzemeCevabi));
+    clock_gettime(CLOCK_MONOTONIC, &bitis);
+    
+    // Gecikmeyi paylaşımlı sayaçlara ekle (pipe_mutex yalnızca bu process'i korur,
+    // sayaçlar tüm kat process'leriyle paylaşıldığı için atomik güncellenir)
+    gecikme_ns = (bitis.tv_sec - baslangic.tv_sec) * 1000000000L + (bitis.tv_nsec - baslangic.tv_nsec);
+    __sync_fetch_and_add(&istatistik->talep_sayisi, 1);
+    __sync_fetch_and_add(&istatistik->toplam_gecikme_ns, gecikme_ns);
+    eski_max = istatistik->max_gecikme_ns;
+    while (gecikme_ns > eski_max && 
+           !__sync_bool_compare_and_swap(&istatistik->max_gecikme_ns, eski_max, gecikme_ns)) {
+        eski_max = istatistik->max_gecikme_ns;
+    }
     
     // Pipe mutex'ini serbest bırak
     pthread_mutex_unlock(&pipe_mutex);
@@ -256,10 +326,25 @@ void yangin_alarm_kur(int daire_id) {
 void* daire_insa_et(void* parametre) {
     DaireInfo* info = (DaireInfo*)parametre;
     char buffer[MAX_BUFFER];
+    long baslangic_goc;
+    
+    // Daire thread'ini kendi çekirdeğine sabitle (istenmişse)
+    if (info->cekirdek >= 0) {
+        cpu_set_t kume;
+        CPU_ZERO(&kume);
+        CPU_SET(info->cekirdek, &kume);
+        if (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &kume) != 0) {
+            snprintf(buffer, sizeof(buffer), 
+                    "⚠️  Daire %d: Çekirdek %d'e sabitlenemedi, katın kümesinde çalışacak\n", 
+                    info->global_daire_id, info->cekirdek);
+            guvenli_yazdir(buffer);
+        }
+    }
+    baslangic_goc = goc_sayisi_oku();   // Sabitlemenin yol açtığı göç sayılmaz
     
     snprintf(buffer, sizeof(buffer), 
-            "🏠 Daire %d başlıyor (Kat %d)\n", 
-            info->global_daire_id, info->kat_no);
+            "🏠 Daire %d başlıyor (Kat %d, Çekirdek %d)\n", 
+            info->global_daire_id, info->kat_no, sched_getcpu());
     guvenli_yazdir(buffer);
     
     // 1. Malzeme kontrolü - KRİTİK NOKTA
@@ -275,6 +360,7 @@ void* daire_insa_et(void* parametre) {
                 info->global_daire_id);
         guvenli_yazdir(buffer);
         
+        goc_sayisi_kaydet(baslangic_goc, &istatistik->daire_goc_sayisi);
         return NULL;  // Thread'i sonlandır
     }
     
@@ -301,6 +387,7 @@ void* daire_insa_et(void* parametre) {
     snprintf(buffer, sizeof(buffer), "🎉 Daire %d TAMAMLANDI!\n", info->global_daire_id);
     guvenli_yazdir(buffer);
     
+    goc_sayisi_kaydet(baslangic_goc, &istatistik->daire_goc_sayisi);
     return NULL;
 }
 
@@ -312,6 +399,8 @@ void kat_insa_et(int kat_no, int pipe_talep_fd, int pipe_cevap_fd) {
     char buffer[MAX_BUFFER];
     pthread_t thread_listesi[DAIRE_SAYISI];
     DaireInfo daire_bilgileri[DAIRE_SAYISI];
+    int grup = cekirdek_grubu_sec(kat_no);
+    int ilk = 0, son = kat_cekirdek_sayisi;   // Katın kullanabileceği kat_cekirdekleri aralığı
     
     // Process içi senkronizasyon başlat
     process_senkronizasyon_baslat();
@@ -320,6 +409,31 @@ void kat_insa_et(int kat_no, int pipe_talep_fd, int pipe_cevap_fd) {
             "\n🏗️  *** KAT %d İNŞAATI BAŞLIYOR (4 Daire Paralel) ***\n", kat_no);
     guvenli_yazdir(buffer);
     
+    // Kat process'ini seçilen çekirdek grubuna yerleştir (thread'ler bu kümeyi miras alır)
+    if (yerlesim.kat_yerlesim != KAT_SERBEST) {
+        cpu_set_t kume;
+        cekirdek_grubu_kumesi(grup, &kume);
+        ilk = grup_ilk[grup];
+        son = grup_ilk[grup+1];
+        if (sched_setaffinity(0, sizeof(cpu_set_t), &kume) == -1) {
+            perror("⚠️  Kat process'i çekirdek grubuna sabitlenemedi");
+        } else {
+            snprintf(buffer, sizeof(buffer), 
+                    "📌 Kat %d: Çekirdek grubu %d'e yerleştirildi\n", kat_no, grup);
+            guvenli_yazdir(buffer);
+        }
+    } else if (yerlesim.depo_cekirdek >= 0) {
+        // Serbest yerleşimde de depo çekirdeği katlara verilmez
+        cpu_set_t kume;
+        CPU_ZERO(&kume);
+        for (int i = 0; i < kat_cekirdek_sayisi; i++) {
+            CPU_SET(kat_cekirdekleri[i], &kume);
+        }
+        if (sched_setaffinity(0, sizeof(cpu_set_t), &kume) == -1) {
+            perror("⚠️  Kat process'i depo dışı çekirdeklere yerleştirilemedi");
+        }
+    }
+    
     // Her daire için thread oluştur
     for (int daire = 1; daire <= DAIRE_SAYISI; daire++) {
         int global_id = ((kat_no-1) * DAIRE_SAYISI) + daire;
@@ -330,6 +444,8 @@ void kat_insa_et(int kat_no, int pipe_talep_fd, int pipe_cevap_fd) {
         daire_bilgileri[daire-1].global_daire_id = global_id;
         daire_bilgileri[daire-1].pipe_talep_fd = pipe_talep_fd;
         daire_bilgileri[daire-1].pipe_cevap_fd = pipe_cevap_fd;
+        daire_bilgileri[daire-1].cekirdek = yerlesim.daire_sabitle ? 
+                                            daire_cekirdegi_sec(ilk, son, daire-1) : -1;
         
         // Thread oluştur
         if (pthread_create(&thread_listesi[daire-1], NULL, 
@@ -403,8 +519,20 @@ void malzeme_sunucu_calistir(int pipe_talep_fd, int pipe_cevap_fd) {
     MalzemeTalebi talep;
     MalzemeCevabi cevap;
     int tamamlanan_daire = 0;
+    long baslangic_goc;
     
-    printf("🏪 MALZEME DEPOSU HİZMETE BAŞLADI!\n");
+    // Depoyu kendi çekirdeğine sabitle - katlar bu çekirdeği kullanmaz
+    if (yerlesim.depo_cekirdek >= 0) {
+        cpu_set_t kume;
+        CPU_ZERO(&kume);
+        CPU_SET(yerlesim.depo_cekirdek, &kume);
+        if (sched_setaffinity(0, sizeof(cpu_set_t), &kume) == -1) {
+            perror("⚠️  Depo çekirdeğe sabitlenemedi");
+        }
+    }
+    baslangic_goc = goc_sayisi_oku();
+    
+    printf("🏪 MALZEME DEPOSU HİZMETE BAŞLADI! (Çekirdek %d)\n", sched_getcpu());
     printf("   📦 Başlangıç stok: %d birim\n", toplam_malzeme);
     printf("   📋 Her daire için gerekli: %d birim\n", DAIRE_MALZEME);
     printf("   🏠 Toplam daire sayısı: %d\n", KAT_SAYISI * DAIRE_SAYISI);
@@ -467,6 +595,321 @@ void malzeme_sunucu_calistir(int pipe_talep_fd, int pipe_cevap_fd) {
         // Cevabı gönder
         write(pipe_cevap_fd, &cevap, sizeof(MalzemeCevabi));
     }
+    
+    goc_sayisi_kaydet(baslangic_goc, &istatistik->depo_goc_sayisi);
+}
+
+/**
+ * Komut satırı yerleşim ayarlarını okuyan fonksiyon
+ * Depo çekirdeği, kat yerleşimi ve daire thread sabitlemesi burada belirlenir
+ */
+void yerlesim_ayarlarini_oku(int argc, char* argv[]) {
+    static struct option secenekler[] = {
+        {"depo-cekirdek", required_argument, NULL, 'd'},
+        {"kat-yerlesim",  required_argument, NULL, 'k'},
+        {"grup-boyutu",   required_argument, NULL, 'g'},
+        {"daire-sabitle", no_argument,       NULL, 's'},
+        {"yardim",        no_argument,       NULL, 'h'},
+        {NULL, 0, NULL, 0}
+    };
+    int secenek;
+    long sayi;
+    char* son;
+    FILE* cikti;
+    
+    while ((secenek = getopt_long(argc, argv, "d:k:g:sh", secenekler, NULL)) != -1) {
+        switch (secenek) {
+            case 'd':
+                sayi = strtol(optarg, &son, 10);
+                if (son == optarg || *son != '\0' || sayi < 0 || sayi >= CPU_SETSIZE) {
+                    fprintf(stderr, "❌ Geçersiz depo çekirdeği: %s (0 ile %d arasında olmalı)\n", 
+                            optarg, CPU_SETSIZE - 1);
+                    exit(1);
+                }
+                yerlesim.depo_cekirdek = (int)sayi;
+                break;
+            case 'k':
+                if (strcmp(optarg, "serbest") == 0) {
+                    yerlesim.kat_yerlesim = KAT_SERBEST;
+                } else if (strcmp(optarg, "yay") == 0) {
+                    yerlesim.kat_yerlesim = KAT_YAY;
+                } else if (strcmp(optarg, "topla") == 0) {
+                    yerlesim.kat_yerlesim = KAT_TOPLA;
+                } else {
+                    fprintf(stderr, "❌ Geçersiz kat yerleşimi: %s (serbest, yay, topla)\n", optarg);
+                    exit(1);
+                }
+                break;
+            case 'g':
+                sayi = strtol(optarg, &son, 10);
+                if (son == optarg || *son != '\0' || sayi < 1 || sayi > CPU_SETSIZE) {
+                    fprintf(stderr, "❌ Grup boyutu en az 1 olmalı: %s\n", optarg);
+                    exit(1);
+                }
+                yerlesim.grup_boyutu = (int)sayi;
+                break;
+            case 's':
+                yerlesim.daire_sabitle = 1;
+                break;
+            case 'h':
+            default:
+                // Yardım istendiyse stdout'a, hatalı seçenekte stderr'e yaz
+                cikti = (secenek == 'h') ? stdout : stderr;
+                fprintf(cikti, "Kullanım: %s [seçenekler]\n", argv[0]);
+                fprintf(cikti, "  -d, --depo-cekirdek N   Malzeme deposunu N numaralı çekirdeğe sabitle\n");
+                fprintf(cikti, "  -k, --kat-yerlesim Y    Kat process'leri: serbest (varsayılan), yay, topla\n");
+                fprintf(cikti, "  -g, --grup-boyutu N     Bir çekirdek grubundaki çekirdek sayısı (varsayılan %d)\n", DAIRE_SAYISI);
+                fprintf(cikti, "  -s, --daire-sabitle     Her daire thread'ini katın kümesinde ayrı bir çekirdeğe sabitle\n");
+                fprintf(cikti, "  -h, --yardim            Bu yardımı göster\n");
+                exit(secenek == 'h' ? 0 : 1);
+        }
+    }
+}
+
+/**
+ * Çekirdeğin topoloji bilgisini (soket veya fiziksel çekirdek numarası) sysfs'ten okur
+ * Dosya yoksa 0 döner (tek soketli kabul edilir)
+ */
+int topoloji_oku(int cekirdek, const char* alan) {
+    char yol[128];
+    int deger = 0;
+    FILE* dosya;
+    
+    snprintf(yol, sizeof(yol), "/sys/devices/system/cpu/cpu%d/topology/%s", cekirdek, alan);
+    dosya = fopen(yol, "r");
+    if (dosya != NULL) {
+        if (fscanf(dosya, "%d", &deger) != 1) {
+            deger = 0;
+        }
+        fclose(dosya);
+    }
+    return deger;
+}
+
+/**
+ * Kat çekirdeklerini sıralamak için karşılaştırma fonksiyonu
+ * Sıra: önce deponun soketi, sonra soket, fiziksel çekirdek ve çekirdek numarası
+ */
+int cekirdek_karsilastir(const void* a, const void* b) {
+    int x = *(const int*)a, y = *(const int*)b;
+    int x_uzak = cekirdek_paketi[x] != depo_paketi;
+    int y_uzak = cekirdek_paketi[y] != depo_paketi;
+    
+    if (x_uzak != y_uzak) return x_uzak - y_uzak;
+    if (cekirdek_paketi[x] != cekirdek_paketi[y]) return cekirdek_paketi[x] - cekirdek_paketi[y];
+    if (cekirdek_kimligi[x] != cekirdek_kimligi[y]) return cekirdek_kimligi[x] - cekirdek_kimligi[y];
+    return x - y;
+}
+
+/**
+ * Çekirdeğin depo ile aynı fiziksel çekirdekte (aynı soket ve core_id) olup olmadığını döner
+ */
+int depo_kardesi_mi(int cekirdek) {
+    return cekirdek_paketi[cekirdek] == cekirdek_paketi[yerlesim.depo_cekirdek] && 
+           cekirdek_kimligi[cekirdek] == cekirdek_kimligi[yerlesim.depo_cekirdek];
+}
+
+/**
+ * Katlara ayrılacak çekirdek listesini ve çekirdek gruplarını hazırlayan fonksiyon
+ * Depo bir çekirdeğe sabitlendiyse o fiziksel çekirdek (SMT kardeşleriyle) katlara verilmez
+ * Gruplar soket sınırını aşmaz; aynı fiziksel çekirdeğin thread'leri aynı grupta kalır,
+ * bu yüzden SMT'li sistemlerde bir grup --grup-boyutu değerinden biraz büyük olabilir
+ */
+void kat_cekirdeklerini_hazirla() {
+    cpu_set_t izinli;
+    int gruptaki_sira[CPU_SETSIZE];
+    int gruptaki = 0;
+    int n = 0;
+    
+    if (sched_getaffinity(0, sizeof(cpu_set_t), &izinli) == -1) {
+        perror("❌ Çekirdek kümesi okunamadı");
+        exit(1);
+    }
+    
+    if (yerlesim.depo_cekirdek >= 0 && !CPU_ISSET(yerlesim.depo_cekirdek, &izinli)) {
+        fprintf(stderr, "❌ Depo çekirdeği %d kullanılamıyor\n", yerlesim.depo_cekirdek);
+        exit(1);
+    }
+    
+    for (int cekirdek = 0; cekirdek < CPU_SETSIZE; cekirdek++) {
+        if (CPU_ISSET(cekirdek, &izinli)) {
+            cekirdek_paketi[cekirdek] = topoloji_oku(cekirdek, "physical_package_id");
+            cekirdek_kimligi[cekirdek] = topoloji_oku(cekirdek, "core_id");
+        }
+    }
+    
+    // Depo sabitlendiyse deponun fiziksel çekirdeği (SMT kardeşleri dahil) katlara verilmez
+    for (int cekirdek = 0; cekirdek < CPU_SETSIZE; cekirdek++) {
+        if (CPU_ISSET(cekirdek, &izinli) && 
+            (yerlesim.depo_cekirdek < 0 || !depo_kardesi_mi(cekirdek))) {
+            kat_cekirdekleri[kat_cekirdek_sayisi++] = cekirdek;
+        }
+    }
+    
+    // Başka fiziksel çekirdek yoksa önce deponun SMT kardeşleri kullanılır
+    if (kat_cekirdek_sayisi == 0) {
+        for (int cekirdek = 0; cekirdek < CPU_SETSIZE; cekirdek++) {
+            if (CPU_ISSET(cekirdek, &izinli) && cekirdek != yerlesim.depo_cekirdek) {
+                kat_cekirdekleri[kat_cekirdek_sayisi++] = cekirdek;
+            }
+        }
+        if (kat_cekirdek_sayisi > 0) {
+            fprintf(stderr, "⚠️  Depo dışında boş fiziksel çekirdek yok, katlar deponun SMT kardeşlerini kullanacak\n");
+        }
+    }
+    
+    // Tek çekirdekli sistemde depo çekirdeği katlarla paylaşılmak zorunda
+    if (kat_cekirdek_sayisi == 0) {
+        fprintf(stderr, "⚠️  Depo dışında boş çekirdek yok, katlar depo çekirdeğini paylaşacak\n");
+        kat_cekirdekleri[kat_cekirdek_sayisi++] = yerlesim.depo_cekirdek;
+    }
+    
+    if (yerlesim.grup_boyutu > kat_cekirdek_sayisi) {
+        yerlesim.grup_boyutu = kat_cekirdek_sayisi;
+    }
+    
+    // Deponun soketindeki çekirdekler başa gelsin (toplama yerleşimi depoya yakın kalır)
+    depo_paketi = (yerlesim.depo_cekirdek >= 0) ? cekirdek_paketi[yerlesim.depo_cekirdek] 
+                                                 : cekirdek_paketi[kat_cekirdekleri[0]];
+    qsort(kat_cekirdekleri, kat_cekirdek_sayisi, sizeof(int), cekirdek_karsilastir);
+    
+    // Grupları oluştur: soket değişince veya grup dolduktan sonra yeni fiziksel çekirdeğe
+    // geçilince yeni grup başlar (grup boyutu tam fiziksel çekirdeğe yuvarlanır)
+    for (int i = 0; i < kat_cekirdek_sayisi; i++) {
+        int paket = cekirdek_paketi[kat_cekirdekleri[i]];
+        if (i == 0 || paket != cekirdek_paketi[kat_cekirdekleri[i-1]] || 
+            (gruptaki >= yerlesim.grup_boyutu && 
+             cekirdek_kimligi[kat_cekirdekleri[i]] != cekirdek_kimligi[kat_cekirdekleri[i-1]])) {
+            int ayni_paket_grubu = 0;
+            for (int g = 0; g < grup_sayisi; g++) {
+                if (cekirdek_paketi[kat_cekirdekleri[grup_ilk[g]]] == paket) {
+                    ayni_paket_grubu++;
+                }
+            }
+            gruptaki_sira[grup_sayisi] = ayni_paket_grubu;
+            grup_ilk[grup_sayisi++] = i;
+            gruptaki = 0;
+        }
+        gruptaki++;
+    }
+    grup_ilk[grup_sayisi] = kat_cekirdek_sayisi;
+    
+    // Yayma sırası: soketler arasında dönüşümlü (soket 0 grup 0, soket 1 grup 0, ...)
+    for (int sira = 0; n < grup_sayisi; sira++) {
+        for (int g = 0; g < grup_sayisi; g++) {
+            if (gruptaki_sira[g] == sira) {
+                yay_sirasi[n++] = g;
+            }
+        }
+    }
+    
+    for (int i = 0; i < kat_cekirdek_sayisi; i++) {
+        int paket = cekirdek_paketi[kat_cekirdekleri[i]];
+        int yeni = 1;
+        for (int j = 0; j < i; j++) {
+            if (cekirdek_paketi[kat_cekirdekleri[j]] == paket) {
+                yeni = 0;
+                break;
+            }
+        }
+        soket_sayisi += yeni;
+    }
+}
+
+/**
+ * Kata ait çekirdek grubunu seçen fonksiyon
+ * Toplama yerleşiminde tüm katlar deponun soketindeki 0. grupta,
+ * diğerlerinde katlar gruplara soketler arasında dönüşümlü dağılır
+ */
+int cekirdek_grubu_sec(int kat_no) {
+    if (yerlesim.kat_yerlesim == KAT_TOPLA) {
+        return 0;
+    }
+    return yay_sirasi[(kat_no - 1) % grup_sayisi];
+}
+
+/**
+ * Çekirdek grubunu cpu_set_t kümesine çeviren fonksiyon
+ */
+void cekirdek_grubu_kumesi(int grup, cpu_set_t* kume) {
+    CPU_ZERO(kume);
+    for (int i = grup_ilk[grup]; i < grup_ilk[grup+1]; i++) {
+        CPU_SET(kat_cekirdekleri[i], kume);
+    }
+}
+
+/**
+ * Daire thread'i için katın çekirdek aralığından [ilk, son) bir çekirdek seçer
+ * Önce farklı fiziksel çekirdekler, onlar bitince SMT kardeşleri kullanılır
+ */
+int daire_cekirdegi_sec(int ilk, int son, int sira) {
+    int kardes_sirasi[CPU_SETSIZE];
+    int en_buyuk_sira = 0;
+    
+    // Her çekirdeğin kendi fiziksel çekirdeğindeki sırası (0: ilk hyperthread)
+    for (int i = ilk; i < son; i++) {
+        kardes_sirasi[i] = 0;
+        for (int j = ilk; j < i; j++) {
+            if (cekirdek_paketi[kat_cekirdekleri[j]] == cekirdek_paketi[kat_cekirdekleri[i]] && 
+                cekirdek_kimligi[kat_cekirdekleri[j]] == cekirdek_kimligi[kat_cekirdekleri[i]]) {
+                kardes_sirasi[i]++;
+            }
+        }
+        if (kardes_sirasi[i] > en_buyuk_sira) {
+            en_buyuk_sira = kardes_sirasi[i];
+        }
+    }
+    
+    sira %= (son - ilk);
+    for (int kardes = 0; kardes <= en_buyuk_sira; kardes++) {
+        for (int i = ilk; i < son; i++) {
+            if (kardes_sirasi[i] == kardes && sira-- == 0) {
+                return kat_cekirdekleri[i];
+            }
+        }
+    }
+    return kat_cekirdekleri[ilk];
+}
+
+/**
+ * Çağıran thread'in çekirdek göçü sayısını okuyan fonksiyon
+ * Çekirdeğin tuttuğu se.nr_migrations değeri /proc/self/task/<tid>/sched dosyasından okunur
+ * Okunamazsa -1 döner
+ */
+long goc_sayisi_oku() {
+    char yol[64], satir[256];
+    long goc = -1;
+    FILE* dosya;
+    
+    snprintf(yol, sizeof(yol), "/proc/self/task/%ld/sched", (long)syscall(SYS_gettid));
+    dosya = fopen(yol, "r");
+    if (dosya == NULL) {
+        return -1;
+    }
+    while (fgets(satir, sizeof(satir), dosya) != NULL) {
+        if (strncmp(satir, "se.nr_migrations", 16) == 0) {
+            char* ayrac = strchr(satir, ':');
+            if (ayrac != NULL) {
+                goc = strtol(ayrac + 1, NULL, 10);
+            }
+            break;
+        }
+    }
+    fclose(dosya);
+    return goc;
+}
+
+/**
+ * Thread'in başlangıçtan bu yana yaptığı çekirdek göçlerini paylaşımlı sayaca ekler
+ */
+void goc_sayisi_kaydet(long baslangic, long* sayac) {
+    long bitis = goc_sayisi_oku();
+    
+    if (baslangic < 0 || bitis < 0) {
+        istatistik->goc_olculemedi = 1;
+        return;
+    }
+    __sync_fetch_and_add(sayac, bitis - baslangic);   // Aynı kattaki thread'ler eş zamanlı ekleyebilir
 }
 
 /**
@@ -509,7 +952,22 @@ void ciz_apartman() {
     
 }
 
-int main() {
+int main(int argc, char* argv[]) {
+    const char* kat_yerlesim_adlari[] = { "serbest", "yay", "topla" };
+    
+    // Yerleşim ayarlarını oku ve katlara ayrılacak çekirdekleri belirle
+    yerlesim_ayarlarini_oku(argc, argv);
+    kat_cekirdeklerini_hazirla();
+    
+    // Ölçüm sayaçları tüm process'lerce görülebilmesi için paylaşımlı bellekte tutulur
+    istatistik = mmap(NULL, sizeof(YerlesimIstatistik), PROT_READ | PROT_WRITE, 
+                      MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (istatistik == MAP_FAILED) {
+        perror("❌ Paylaşımlı bellek oluşturulamadı");
+        exit(1);
+    }
+    memset(istatistik, 0, sizeof(YerlesimIstatistik));
+    
     printf("🏢 ÜÇBEY APARTMANI İNŞAAT SİMÜLASYONU BAŞLIYOR\n");
     printf("======================================\n");
     printf("📋 Proje Detayları:\n");
@@ -520,7 +978,15 @@ int main() {
     printf("   💰 Her daire malzeme ihtiyacı: %d birim\n", DAIRE_MALZEME);
     printf("   🔧 Sınırlı kaynaklar: 1 Vinç, 1 Asansör, 2 Elektrikçi, 2 Tesisatçı, 3 Yangın Alarmı Teknisyeni\n");
     printf("   ⚠️  Önemli: Aynı kattaki daireler elektrik ve su tesisatını sıralı yapar (ortak sistem)\n");
-    printf("   🚨 Yangın alarmı: Tüm dairelerde paralel kurulum (bağımsız sistem)\n\n");
+    printf("   🚨 Yangın alarmı: Tüm dairelerde paralel kurulum (bağımsız sistem)\n");
+    if (yerlesim.depo_cekirdek >= 0) {
+        printf("   📌 Yerleşim: Depo çekirdek %d, ", yerlesim.depo_cekirdek);
+    } else {
+        printf("   📌 Yerleşim: Depo serbest, ");
+    }
+    printf("katlar '%s', grup boyutu %d, daire sabitleme %s\n\n", 
+           kat_yerlesim_adlari[yerlesim.kat_yerlesim], yerlesim.grup_boyutu, 
+           yerlesim.daire_sabitle ? "açık" : "kapalı");
     
     // Pipe'ları oluştur
     int pipe_talep[2], pipe_cevap[2];
@@ -533,6 +999,7 @@ int main() {
     printf("🔧 İletişim kanalları oluşturuldu\n");
     
     // Malzeme sunucu process'ini başlat
+    fflush(stdout);             // Tampondaki çıktı child process'lere kopyalanmasın
     pid_t sunucu_pid = fork();
     if (sunucu_pid == 0) {
         close(pipe_talep[1]);
@@ -578,6 +1045,7 @@ int main() {
             printf("⏳ Yapısal istikrar için Kat %d bekleniyor (alt kat tamamlanmalı)...\n", kat-1);
         }
         
+        fflush(stdout);         // Tampondaki çıktı kat process'ine kopyalanmasın
         pid_t kat_pid = fork();
         
         if (kat_pid == 0) {
@@ -654,6 +1122,28 @@ int main() {
     printf("   🔒 Tesisatı sıralama: ✅ Kat bazında mutex ile ortak sistem korundu\n");
     printf("   🚨 Yangın alarmı: ✅ Paralel kurulum ile hızlı tamamlama\n");
     
+    // Çekirdek yerleşimi ve depo gecikmesi ölçümleri
+    printf("\n📌 YERLEŞİM RAPORU:\n");
+    if (yerlesim.depo_cekirdek >= 0) {
+        printf("   🏪 Depo çekirdeği: %d\n", yerlesim.depo_cekirdek);
+    } else {
+        printf("   🏪 Depo çekirdeği: serbest\n");
+    }
+    printf("   🏗️  Kat yerleşimi: %s (grup boyutu %d, %d grup, %d çekirdek, %d soket)\n", 
+           kat_yerlesim_adlari[yerlesim.kat_yerlesim], yerlesim.grup_boyutu, grup_sayisi, 
+           kat_cekirdek_sayisi, soket_sayisi);
+    printf("   🧵 Daire thread sabitleme: %s\n", yerlesim.daire_sabitle ? "açık" : "kapalı");
+    if (istatistik->goc_olculemedi) {
+        printf("   ⚠️  Çekirdek göçü: /proc/.../sched okunamadı, sayılar eksik olabilir\n");
+    }
+    printf("   🔀 Daire thread çekirdek göçü: %ld\n", istatistik->daire_goc_sayisi);
+    printf("   🔀 Depo çekirdek göçü: %ld\n", istatistik->depo_goc_sayisi);
+    if (istatistik->talep_sayisi > 0) {
+        printf("   ⏱️  Depo gecikmesi: ort. %.1f µs, en fazla %.1f µs (%ld talep)\n", 
+               istatistik->toplam_gecikme_ns / 1000.0 / istatistik->talep_sayisi, 
+               istatistik->max_gecikme_ns / 1000.0, istatistik->talep_sayisi);
+    }
+    
     if (malzeme_tukendi) {
         printf("\n⚠️  ÜÇBEY APARTMANI KISMI OLARAK KULLANIMA HAZIR!\n");
         printf("   (Malzeme yetersizliği nedeniyle tüm katlar tamamlanamadı)\n");
@@ -662,5 +1152,6 @@ int main() {
     }
     
     ciz_apartman();
+    munmap(istatistik, sizeof(YerlesimIstatistik));
     return 0;
 }
\ No newline at end of file